@@ -0,0 +1,46 @@
+/*
+ * cortex_m4.h
+ *
+ * Cortex-M4 core registers (SCB, DWT) shared by the drivers
+ */
+
+
+#ifndef CORTEX_M4_H_
+#define CORTEX_M4_H_
+
+#include "STD_TYPES.h"
+
+/* System Control Block */
+#define SCB_VTOR             (*(volatile u32 *)0xE000ED08U)   /*< Vector table offset register     */
+#define SCB_SCR              (*(volatile u32 *)0xE000ED10U)   /*< System control register          */
+#define SCB_CPACR            (*(volatile u32 *)0xE000ED88U)   /*< Coprocessor access control       */
+
+#define SCB_SCR_SLEEPDEEP_BIT 2
+#define CPACR_CP10_CP11_FULL (0xFU << 20)
+
+/* Debug / DWT cycle counter */
+#define DEMCR                (*(volatile u32 *)0xE000EDFCU)   /*< Debug exception and monitor control */
+#define DWT_CTRL             (*(volatile u32 *)0xE0001000U)   /*< DWT control register             */
+#define DWT_CYCCNT           (*(volatile u32 *)0xE0001004U)   /*< DWT cycle counter                */
+
+#define DEMCR_TRCENA_BIT     24
+#define DWT_CYCCNTENA_BIT    0
+
+/* Mask interrupts and return the previous PRIMASK, a pending IRQ still wakes WFI */
+static inline u32 CORE_DisableIrq(void)
+{
+    u32 primask;
+    __asm volatile("mrs %0, primask\n\tcpsid i" : "=r"(primask) : : "memory");
+    return primask;
+}
+
+/* Restore the PRIMASK returned by CORE_DisableIrq */
+static inline void CORE_RestoreIrq(u32 primask)
+{
+    __asm volatile("msr primask, %0" : : "r"(primask) : "memory");
+}
+
+
+
+
+#endif /* CORTEX_M4_H_ */
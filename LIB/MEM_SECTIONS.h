@@ -0,0 +1,27 @@
+/*
+ * mem_sections.h
+ *
+ * Section attributes matching STARTUP/stm32f4_flash.ld
+ */
+
+
+#ifndef MEM_SECTIONS_H_
+#define MEM_SECTIONS_H_
+
+/* Code copied to SRAM at reset, runs without flash wait states.
+   CCM RAM is on the D-bus only, so code can not be executed from it.
+   long_call only works when it is on the prototype the caller sees */
+#if defined(__arm__)
+#define RAM_FUNC        __attribute__((section(".ramfunc"), noinline, long_call))
+#else
+#define RAM_FUNC        __attribute__((section(".ramfunc"), noinline))
+#endif
+
+/* Initialized / zeroed data placed in the 64KB CCM RAM (no DMA access) */
+#define CCM_DATA        __attribute__((section(".ccmdata")))
+#define CCM_BSS         __attribute__((section(".ccmbss")))
+
+
+
+
+#endif /* MEM_SECTIONS_H_ */
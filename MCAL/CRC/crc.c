@@ -0,0 +1,469 @@
+#include "crc.h"
+#include "rcc.h"
+
+// Feeds whole words (Words * 4 bytes) to the running CRC
+typedef void (*CRC_Feed_t)(CRC_Context_t *Ctx, const u8 *Data, u32 Words);
+
+static u32 CRC_Table[8][256];
+static u8 CRC_TableReady = 0;
+
+// Load a word the same way the CPU does on the target (little endian)
+static u32 CRC_LoadWord(const u8 *Data)
+{
+    return (u32)Data[0] | ((u32)Data[1] << 8) | ((u32)Data[2] << 16) | ((u32)Data[3] << 24);
+}
+
+/*Build the slicing-by-8 tables.
+CRC_Table[0] is the plain MSB first table, CRC_Table[k] advances a byte
+through k more zero bytes*/
+static void CRC_BuildTable(void)
+{
+    u32 n;
+    u32 k;
+    u32 bit;
+    u32 crc;
+
+    for (n = 0; n < 256; n++)
+    {
+        crc = n << 24;
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80000000U) ? ((crc << 1) ^ CRC_POLY) : (crc << 1);
+        }
+        CRC_Table[0][n] = crc;
+    }
+
+    for (k = 1; k < 8; k++)
+    {
+        for (n = 0; n < 256; n++)
+        {
+            crc = CRC_Table[k - 1][n];
+            CRC_Table[k][n] = (crc << 8) ^ CRC_Table[0][crc >> 24];
+        }
+    }
+
+    CRC_TableReady = 1;
+}
+
+// Software feed, two words per iteration
+static void CRC_SoftFeed(CRC_Context_t *Ctx, const u8 *Data, u32 Words)
+{
+    u32 crc = Ctx->crc;
+    u32 next;
+
+    while (Words >= 2)
+    {
+        crc ^= CRC_LoadWord(Data);
+        next = CRC_LoadWord(Data + 4);
+        crc = CRC_Table[7][crc >> 24] ^
+              CRC_Table[6][(crc >> 16) & 0xFF] ^
+              CRC_Table[5][(crc >> 8) & 0xFF] ^
+              CRC_Table[4][crc & 0xFF] ^
+              CRC_Table[3][next >> 24] ^
+              CRC_Table[2][(next >> 16) & 0xFF] ^
+              CRC_Table[1][(next >> 8) & 0xFF] ^
+              CRC_Table[0][next & 0xFF];
+        Data += 8;
+        Words -= 2;
+    }
+
+    if (Words)
+    {
+        crc ^= CRC_LoadWord(Data);
+        crc = CRC_Table[3][crc >> 24] ^
+              CRC_Table[2][(crc >> 16) & 0xFF] ^
+              CRC_Table[1][(crc >> 8) & 0xFF] ^
+              CRC_Table[0][crc & 0xFF];
+    }
+
+    Ctx->crc = crc;
+}
+
+#ifndef CRC_SOFTWARE_ONLY
+// Hardware feed, the CRC unit needs 4 AHB cycles per word and stalls back-to-back DR writes
+static void CRC_HwFeed(CRC_Context_t *Ctx, const u8 *Data, u32 Words)
+{
+    (void)Ctx;
+
+    if (((u32)Data & 0x3U) == 0)
+    {
+        const u32 *word = (const u32 *)Data;
+        while (Words >= 4)
+        {
+            CRC->DR = word[0];
+            CRC->DR = word[1];
+            CRC->DR = word[2];
+            CRC->DR = word[3];
+            word += 4;
+            Words -= 4;
+        }
+        while (Words--)
+        {
+            CRC->DR = *word++;
+        }
+    }
+    else
+    {
+        while (Words--)
+        {
+            CRC->DR = CRC_LoadWord(Data);
+            Data += 4;
+        }
+    }
+}
+
+#define CRC_FEED CRC_HwFeed
+#else
+#define CRC_FEED CRC_SoftFeed
+#endif
+
+// Complete a pending word first, feed whole words, keep the rest for later
+static void CRC_Stream(CRC_Context_t *Ctx, const u8 *Data, u32 Len, CRC_Feed_t Feed)
+{
+    u8 word[4];
+    u32 words;
+
+    while (Ctx->tailLen != 0 && Len != 0)
+    {
+        Ctx->tail |= (u32)(*Data++) << (Ctx->tailLen * 8);
+        Ctx->tailLen++;
+        Len--;
+
+        if (Ctx->tailLen == 4)
+        {
+            word[0] = (u8)Ctx->tail;
+            word[1] = (u8)(Ctx->tail >> 8);
+            word[2] = (u8)(Ctx->tail >> 16);
+            word[3] = (u8)(Ctx->tail >> 24);
+            Feed(Ctx, word, 1);
+            Ctx->tail = 0;
+            Ctx->tailLen = 0;
+        }
+    }
+
+    words = Len / 4;
+    if (words)
+    {
+        Feed(Ctx, Data, words);
+        Data += words * 4;
+        Len -= words * 4;
+    }
+
+    while (Len--)
+    {
+        Ctx->tail |= (u32)(*Data++) << (Ctx->tailLen * 8);
+        Ctx->tailLen++;
+    }
+}
+
+// Flush the zero padded tail word
+static void CRC_FlushTail(CRC_Context_t *Ctx, CRC_Feed_t Feed)
+{
+    u8 word[4];
+
+    if (Ctx->tailLen)
+    {
+        word[0] = (u8)Ctx->tail;
+        word[1] = (u8)(Ctx->tail >> 8);
+        word[2] = (u8)(Ctx->tail >> 16);
+        word[3] = (u8)(Ctx->tail >> 24);
+        Feed(Ctx, word, 1);
+        Ctx->tail = 0;
+        Ctx->tailLen = 0;
+    }
+}
+
+// Back to the initial value, no pending bytes, no DMA transfer
+static void CRC_ResetContext(CRC_Context_t *Ctx)
+{
+    Ctx->crc = CRC_INIT_VALUE;
+    Ctx->tail = 0;
+    Ctx->tailLen = 0;
+    Ctx->dmaActive = 0;
+    Ctx->dmaTailLen = 0;
+    Ctx->dmaData = NULL;
+    Ctx->dmaWords = 0;
+}
+
+CRC_ErrorStatus_t CRC_SoftInit(CRC_Context_t *Ctx)
+{
+    if (Ctx == NULL)
+    {
+        return CRC_NULL_PTR;
+    }
+
+    if (!CRC_TableReady)
+    {
+        CRC_BuildTable();
+    }
+
+    CRC_ResetContext(Ctx);
+    return CRC_OK;
+}
+
+CRC_ErrorStatus_t CRC_SoftUpdate(CRC_Context_t *Ctx, const u8 *Data, u32 Len)
+{
+    if (Ctx == NULL || (Data == NULL && Len != 0))
+    {
+        return CRC_NULL_PTR;
+    }
+
+    CRC_Stream(Ctx, Data, Len, CRC_SoftFeed);
+    return CRC_OK;
+}
+
+CRC_ErrorStatus_t CRC_SoftFinal(CRC_Context_t *Ctx, u32 *Crc)
+{
+    if (Ctx == NULL || Crc == NULL)
+    {
+        return CRC_NULL_PTR;
+    }
+
+    CRC_FlushTail(Ctx, CRC_SoftFeed);
+    *Crc = Ctx->crc;
+    return CRC_OK;
+}
+
+#ifndef CRC_SOFTWARE_ONLY
+// Flag offset of CRC_DMA_STREAM inside LISR/HISR
+static const u32 CRC_DmaFlagPos[4] = {0, 6, 16, 22};
+#define CRC_DMA_FLAG_OFFSET  (CRC_DmaFlagPos[CRC_DMA_STREAM % 4])
+#define CRC_DMA_ISR          ((CRC_DMA_STREAM < 4) ? &CRC_DMA2->LISR : &CRC_DMA2->HISR)
+#define CRC_DMA_IFCR         ((CRC_DMA_STREAM < 4) ? &CRC_DMA2->LIFCR : &CRC_DMA2->HIFCR)
+
+// Context whose DMA transfer is writing CRC->DR, NULL when idle
+static CRC_Context_t *CRC_DmaOwner = NULL;
+
+// Hand the next chunk (up to 65535 words) to the DMA stream
+static void CRC_DmaStartChunk(CRC_Context_t *Ctx)
+{
+    CRC_DMAStream_TypeDef *stream = &CRC_DMA2->S[CRC_DMA_STREAM];
+    u32 chunk = (Ctx->dmaWords > CRC_DMA_MAX_TRANSFER) ? CRC_DMA_MAX_TRANSFER : Ctx->dmaWords;
+
+    *CRC_DMA_IFCR = (CRC_DMA_ALL_FLAGS << CRC_DMA_FLAG_OFFSET);
+
+    // In memory-to-memory mode PAR is the source and M0AR the destination
+    stream->PAR = (u32)Ctx->dmaData;
+    stream->M0AR = (u32)&CRC->DR;
+    stream->NDTR = chunk;
+    stream->FCR = 0;
+    stream->CR = (0x2U << CRC_DMA_SxCR_DIR_POS) |
+                 (1U << CRC_DMA_SxCR_PINC_BIT) |
+                 (0x2U << CRC_DMA_SxCR_PSIZE_POS) |
+                 (0x2U << CRC_DMA_SxCR_MSIZE_POS) |
+                 (0x3U << CRC_DMA_SxCR_PL_POS);
+    stream->CR |= (1U << CRC_DMA_SxCR_EN_BIT);
+
+    Ctx->dmaData += chunk * 4;
+    Ctx->dmaWords -= chunk;
+}
+
+CRC_ErrorStatus_t CRC_Init(CRC_Context_t *Ctx)
+{
+    if (Ctx == NULL)
+    {
+        return CRC_NULL_PTR;
+    }
+
+    if (RCC_EnablePeripheralClock(CRC_EN_BIT) != RCC_OK)
+    {
+        return CRC_NOK;
+    }
+
+    // Ctx may be uninitialized here, so check the unit and not Ctx->dmaActive
+    if (CRC_DmaOwner != NULL)
+    {
+        return CRC_BUSY;
+    }
+
+    CRC->CR = (1U << CRC_CR_RESET_BIT); // DR back to 0xFFFFFFFF
+    CRC_ResetContext(Ctx);
+    return CRC_OK;
+}
+
+CRC_ErrorStatus_t CRC_Update(CRC_Context_t *Ctx, const u8 *Data, u32 Len)
+{
+    if (Ctx == NULL || (Data == NULL && Len != 0))
+    {
+        return CRC_NULL_PTR;
+    }
+
+    // Any running transfer (this context or another) is writing CRC->DR
+    if (CRC_DmaOwner != NULL)
+    {
+        return CRC_BUSY;
+    }
+
+    CRC_Stream(Ctx, Data, Len, CRC_FEED);
+    return CRC_OK;
+}
+
+/*Start feeding the word aligned part of Data to CRC->DR through DMA2
+(memory-to-memory mode) and return at once, the CPU is free until
+CRC_UpdateDMAPoll reports CRC_OK. Data must stay valid until then.
+unaligned data, CCM RAM buffers or a pending tail are handled by
+CRC_Update instead. returns CRC_BUSY if the stream is already used by another driver*/
+CRC_ErrorStatus_t CRC_UpdateDMAStart(CRC_Context_t *Ctx, const u8 *Data, u32 Len)
+{
+    CRC_DMAStream_TypeDef *stream = &CRC_DMA2->S[CRC_DMA_STREAM];
+
+    if (Ctx == NULL || (Data == NULL && Len != 0))
+    {
+        return CRC_NULL_PTR;
+    }
+
+    if (Ctx->dmaActive)
+    {
+        return CRC_BUSY;
+    }
+
+    if (Ctx->tailLen != 0 || ((u32)Data & 0x3U) != 0 || Len < 4 ||
+        ((u32)Data < CRC_CCM_END && (u32)Data + Len > CRC_CCM_START))
+    {
+        return CRC_Update(Ctx, Data, Len);
+    }
+
+    if (RCC_EnablePeripheralClock(DMA2_EN_BIT) != RCC_OK)
+    {
+        return CRC_NOK;
+    }
+
+    // Never steal a stream that is running for someone else
+    if (CRC_DmaOwner != NULL || (stream->CR & (1U << CRC_DMA_SxCR_EN_BIT)))
+    {
+        return CRC_BUSY;
+    }
+
+    Ctx->dmaData = Data;
+    Ctx->dmaWords = Len / 4;
+    Ctx->dmaTailLen = (u8)(Len & 0x3U);
+    Ctx->dmaActive = 1;
+    CRC_DmaOwner = Ctx;
+    CRC_DmaStartChunk(Ctx);
+
+    return CRC_OK;
+}
+
+/*Check the transfer started by CRC_UpdateDMAStart.
+returns CRC_BUSY while it runs, CRC_OK once all of Data went into the CRC*/
+CRC_ErrorStatus_t CRC_UpdateDMAPoll(CRC_Context_t *Ctx)
+{
+    u32 flags;
+
+    if (Ctx == NULL)
+    {
+        return CRC_NULL_PTR;
+    }
+
+    if (!Ctx->dmaActive)
+    {
+        return CRC_OK;
+    }
+
+    flags = *CRC_DMA_ISR >> CRC_DMA_FLAG_OFFSET;
+
+    if (flags & (1U << CRC_DMA_TEIF_BIT))
+    {
+        *CRC_DMA_IFCR = (CRC_DMA_ALL_FLAGS << CRC_DMA_FLAG_OFFSET);
+        Ctx->dmaActive = 0;
+        CRC_DmaOwner = NULL;
+        return CRC_DMA_ERROR;
+    }
+
+    if (!(flags & (1U << CRC_DMA_TCIF_BIT)))
+    {
+        return CRC_BUSY;
+    }
+
+    if (Ctx->dmaWords)
+    {
+        CRC_DmaStartChunk(Ctx);
+        return CRC_BUSY;
+    }
+
+    *CRC_DMA_IFCR = (CRC_DMA_ALL_FLAGS << CRC_DMA_FLAG_OFFSET);
+    Ctx->dmaActive = 0;
+    CRC_DmaOwner = NULL;
+
+    // Remaining 0-3 bytes go to the tail
+    CRC_Stream(Ctx, Ctx->dmaData, Ctx->dmaTailLen, CRC_FEED);
+    return CRC_OK;
+}
+
+/*Blocking DMA update, use Start/Poll to overlap other work with the transfer.
+falls back to the CPU when the DMA stream is taken by another driver*/
+CRC_ErrorStatus_t CRC_UpdateDMA(CRC_Context_t *Ctx, const u8 *Data, u32 Len)
+{
+    CRC_ErrorStatus_t Loc_Status;
+
+    if (Ctx != NULL && Ctx->dmaActive)
+    {
+        return CRC_BUSY;
+    }
+
+    Loc_Status = CRC_UpdateDMAStart(Ctx, Data, Len);
+    if (Loc_Status == CRC_BUSY)
+    {
+        return CRC_Update(Ctx, Data, Len);
+    }
+
+    while (Loc_Status == CRC_OK && Ctx->dmaActive)
+    {
+        Loc_Status = CRC_UpdateDMAPoll(Ctx);
+        if (Loc_Status == CRC_BUSY)
+        {
+            Loc_Status = CRC_OK;
+        }
+    }
+
+    return Loc_Status;
+}
+
+CRC_ErrorStatus_t CRC_Final(CRC_Context_t *Ctx, u32 *Crc)
+{
+    if (Ctx == NULL || Crc == NULL)
+    {
+        return CRC_NULL_PTR;
+    }
+
+    if (CRC_DmaOwner != NULL)
+    {
+        return CRC_BUSY;
+    }
+
+    CRC_FlushTail(Ctx, CRC_FEED);
+    *Crc = CRC->DR;
+    return CRC_OK;
+}
+#else
+// Host build, no CRC unit and no DMA
+CRC_ErrorStatus_t CRC_Init(CRC_Context_t *Ctx)
+{
+    return CRC_SoftInit(Ctx);
+}
+
+CRC_ErrorStatus_t CRC_Update(CRC_Context_t *Ctx, const u8 *Data, u32 Len)
+{
+    return CRC_SoftUpdate(Ctx, Data, Len);
+}
+
+CRC_ErrorStatus_t CRC_UpdateDMA(CRC_Context_t *Ctx, const u8 *Data, u32 Len)
+{
+    return CRC_SoftUpdate(Ctx, Data, Len);
+}
+
+CRC_ErrorStatus_t CRC_UpdateDMAStart(CRC_Context_t *Ctx, const u8 *Data, u32 Len)
+{
+    return CRC_SoftUpdate(Ctx, Data, Len);
+}
+
+CRC_ErrorStatus_t CRC_UpdateDMAPoll(CRC_Context_t *Ctx)
+{
+    return (Ctx == NULL) ? CRC_NULL_PTR : CRC_OK;
+}
+
+CRC_ErrorStatus_t CRC_Final(CRC_Context_t *Ctx, u32 *Crc)
+{
+    return CRC_SoftFinal(Ctx, Crc);
+}
+#endif
@@ -0,0 +1,112 @@
+#ifndef _CRC_H_
+#define _CRC_H_
+
+#include "STD_TYPES.h"
+// CRC Registers base address
+#define CRC_BASE_ADDR        0x40023000U
+#define CRC                  ((CRC_TypeDef *)CRC_BASE_ADDR)
+
+// DMA2 base address, the only DMA able to do memory-to-memory transfers
+#define CRC_DMA2_BASE_ADDR   0x40026400U
+#define CRC_DMA2             ((CRC_DMA_TypeDef *)CRC_DMA2_BASE_ADDR)
+
+/*************************************************************************/
+// CRC-32 parameters of the hardware unit (no reflection, no final XOR)
+#define CRC_POLY             0x04C11DB7U
+#define CRC_INIT_VALUE       0xFFFFFFFFU
+
+// CRC_CR bits
+#define CRC_CR_RESET_BIT     0
+
+// DMA2 stream used by CRC_UpdateDMA (0-7), Stream7 is only shared with USART1_TX/SDIO/DCMI/HASH
+#ifndef CRC_DMA_STREAM
+#define CRC_DMA_STREAM       7
+#endif
+
+// CCM RAM is not reachable by the DMA
+#define CRC_CCM_START        0x10000000U
+#define CRC_CCM_END          0x10010000U
+
+// DMA_SxCR bits
+#define CRC_DMA_SxCR_EN_BIT      0
+#define CRC_DMA_SxCR_DIR_POS     6   // 10: memory-to-memory
+#define CRC_DMA_SxCR_PINC_BIT    9
+#define CRC_DMA_SxCR_PSIZE_POS   11  // 10: word
+#define CRC_DMA_SxCR_MSIZE_POS   13  // 10: word
+#define CRC_DMA_SxCR_PL_POS      16  // 11: very high priority
+
+// DMA_xISR flags of a stream, relative to its flag offset
+#define CRC_DMA_TEIF_BIT         3
+#define CRC_DMA_TCIF_BIT         5
+#define CRC_DMA_ALL_FLAGS        0x3DU
+
+#define CRC_DMA_MAX_TRANSFER     0xFFFFU
+
+/* Build with -DCRC_SOFTWARE_ONLY (host build) to run CRC_Init/Update/Final
+   on the slicing-by-8 software implementation instead of the CRC unit */
+
+/*************************************************************************/
+// CRC Registers Structure
+typedef struct {
+    volatile u32 DR;             // CRC data register,                 Offset: 0x00
+    volatile u32 IDR;            // CRC independent data register,     Offset: 0x04
+    volatile u32 CR;             // CRC control register,              Offset: 0x08
+} CRC_TypeDef;
+
+// DMA Stream Registers Structure
+typedef struct {
+    volatile u32 CR;             // DMA stream configuration register,     Offset: 0x00
+    volatile u32 NDTR;           // DMA stream number of data register,    Offset: 0x04
+    volatile u32 PAR;            // DMA stream peripheral address register, Offset: 0x08
+    volatile u32 M0AR;           // DMA stream memory 0 address register,  Offset: 0x0C
+    volatile u32 M1AR;           // DMA stream memory 1 address register,  Offset: 0x10
+    volatile u32 FCR;            // DMA stream FIFO control register,      Offset: 0x14
+} CRC_DMAStream_TypeDef;
+
+// DMA Registers Structure
+typedef struct {
+    volatile u32 LISR;           // DMA low interrupt status register,     Offset: 0x00
+    volatile u32 HISR;           // DMA high interrupt status register,    Offset: 0x04
+    volatile u32 LIFCR;          // DMA low interrupt flag clear register, Offset: 0x08
+    volatile u32 HIFCR;          // DMA high interrupt flag clear register, Offset: 0x0C
+    CRC_DMAStream_TypeDef S[8];  // DMA streams 0-7,                  Offset: 0x10-0xCC
+} CRC_DMA_TypeDef;
+
+// CRC Error Status Enumeration
+typedef enum {
+    CRC_OK = 0,                      // Operation successful
+    CRC_NOK,                         // Operation failed
+    CRC_NULL_PTR,                    // NULL pointer passed
+    CRC_DMA_ERROR,                   // DMA transfer error
+    CRC_BUSY                         // DMA transfer running or stream used by another driver
+} CRC_ErrorStatus_t;
+
+/* Streaming context.
+   the CRC unit holds a single running value, so only one hardware stream
+   can be active at a time. the software API has no such limit */
+typedef struct {
+    u32 crc;                         // Running CRC (software only)
+    u32 tail;                        // Bytes waiting to complete a word
+    u8 tailLen;                      // Number of bytes in tail (0-3)
+    u8 dmaActive;                    // DMA transfer started and not yet polled done
+    u8 dmaTailLen;                   // Bytes left after the DMA words (0-3)
+    const u8 *dmaData;               // Next chunk to hand to the DMA
+    u32 dmaWords;                    // Words not yet handed to the DMA
+} CRC_Context_t;
+
+/*************************************************************************/
+/* Function prototypes */
+/* A trailing partial word is zero padded by Final, both implementations
+   give the same result for the same byte stream */
+CRC_ErrorStatus_t CRC_Init(CRC_Context_t *Ctx);
+CRC_ErrorStatus_t CRC_Update(CRC_Context_t *Ctx, const u8 *Data, u32 Len);
+CRC_ErrorStatus_t CRC_UpdateDMA(CRC_Context_t *Ctx, const u8 *Data, u32 Len);
+CRC_ErrorStatus_t CRC_UpdateDMAStart(CRC_Context_t *Ctx, const u8 *Data, u32 Len);
+CRC_ErrorStatus_t CRC_UpdateDMAPoll(CRC_Context_t *Ctx);
+CRC_ErrorStatus_t CRC_Final(CRC_Context_t *Ctx, u32 *Crc);
+
+CRC_ErrorStatus_t CRC_SoftInit(CRC_Context_t *Ctx);
+CRC_ErrorStatus_t CRC_SoftUpdate(CRC_Context_t *Ctx, const u8 *Data, u32 Len);
+CRC_ErrorStatus_t CRC_SoftFinal(CRC_Context_t *Ctx, u32 *Crc);
+
+#endif // _CRC_H_
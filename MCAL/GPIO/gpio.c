@@ -36,8 +36,8 @@ GPIO_ErrorStatus_t GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitCFG_t *InitStruct)
 
     return GPIO_OK;
 }
-// Write a value to a GPIO pin (output mode)
-GPIO_ErrorStatus_t GPIO_WritePin(GPIO_TypeDef *GPIOx, u16 Pin, GPIO_PinState PinState)
+// Write a value to a GPIO pin (output mode), runs from SRAM
+RAM_FUNC GPIO_ErrorStatus_t GPIO_WritePin(GPIO_TypeDef *GPIOx, u16 Pin, GPIO_PinState PinState)
 {
     // Validate input parameters
     if (GPIOx == NULL || Pin > GPIO_PIN_15)
@@ -68,8 +68,8 @@ GPIO_ErrorStatus_t GPIO_ReadPin(GPIO_TypeDef *GPIOx, u16 Pin, GPIO_PinState *Pin
     *PinState = (GPIOx->IDR & (1 << Pin)) ? GPIO_PIN_SET : GPIO_PIN_RESET;
     return GPIO_OK;
 }
-// Toggle the state of a GPIO pin (output mode)
-GPIO_ErrorStatus_t GPIO_TogglePin(GPIO_TypeDef *GPIOx, u16 Pin)
+// Toggle the state of a GPIO pin (output mode), runs from SRAM
+RAM_FUNC GPIO_ErrorStatus_t GPIO_TogglePin(GPIO_TypeDef *GPIOx, u16 Pin)
 {
     // Validate input parameters
     if (GPIOx == NULL || Pin > GPIO_PIN_15)
@@ -118,5 +118,5 @@ GPIO_ErrorStatus_t GPIO_LockPin(GPIO_TypeDef *GPIOx, u16 Pin)
     GPIOx->LCKR = (1 << Pin); // Write again to confirm
     GPIOx->LCKR = lock;       // Write again to confirm
     u32 is_locked = GPIOx->LCKR; // Read the LCKR register to check if the lock was successful
-    return GPIO_OK;
+    return (is_locked & (1 << 16)) ? GPIO_OK : GPIO_NOK;
 }
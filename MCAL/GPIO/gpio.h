@@ -2,6 +2,8 @@
 #define _GPIO_H_
 
 #include "STD_TYPES.h"
+#include "MEM_SECTIONS.h"
+
 // GPIO Registers base address
 #define GPIOA_BASE_ADDR      0x40020000U
 #define GPIOB_BASE_ADDR      0x40020400U
@@ -31,16 +33,6 @@ typedef struct {
     volatile u32 AFR[2];         // GPIO alternate function registers,     Offset: 0x20-0x24
 } GPIO_TypeDef;
 
-// GPIO Configuration Structure
-typedef struct {
-    GPIO_Port_t port;                // GPIO port (e.g., GPIO_PORT_A)
-    GPIO_Pin_t pin;                  // GPIO pin (e.g., GPIO_PIN_5)
-    GPIO_PinMode_t mode;             // GPIO pin mode (input, output, alternate, analog)
-    GPIO_OutputType_t outputType;    // GPIO output type (push-pull, open-drain)
-    GPIO_InputType_t inputType;      // GPIO input type (no pull, pull-up, pull-down)
-    GPIO_OutputSpeed_t speed;        // GPIO output speed (low, medium, high, very high)
-} GPIO_InitCFG_t;
-
 // GPIO Pin Mode Enumeration
 typedef enum {
     GPIO_PIN_MODE_INPUT = 0,         // Input mode
@@ -106,6 +98,16 @@ typedef enum {
     GPIO_NOK                         // Operation failed
 } GPIO_ErrorStatus_t;
 
+// GPIO Configuration Structure
+typedef struct {
+    GPIO_Port_t port;                // GPIO port (e.g., GPIO_PORT_A)
+    GPIO_Pin_t pin;                  // GPIO pin (e.g., GPIO_PIN_5)
+    GPIO_PinMode_t mode;             // GPIO pin mode (input, output, alternate, analog)
+    GPIO_OutputType_t outputType;    // GPIO output type (push-pull, open-drain)
+    GPIO_InputType_t inputType;      // GPIO input type (no pull, pull-up, pull-down)
+    GPIO_OutputSpeed_t speed;        // GPIO output speed (low, medium, high, very high)
+} GPIO_InitCFG_t;
+
 typedef enum {
     GPIO_PIN_RESET = 0,
     GPIO_PIN_SET
@@ -130,4 +132,12 @@ typedef enum {
     GPIO_AF15
 } GPIO_AlternateFunction_t;
 
+// Function prototypes (the write/toggle hot paths run from SRAM)
+GPIO_ErrorStatus_t GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitCFG_t *InitStruct);
+RAM_FUNC GPIO_ErrorStatus_t GPIO_WritePin(GPIO_TypeDef *GPIOx, u16 Pin, GPIO_PinState PinState);
+GPIO_ErrorStatus_t GPIO_ReadPin(GPIO_TypeDef *GPIOx, u16 Pin, GPIO_PinState *PinState);
+RAM_FUNC GPIO_ErrorStatus_t GPIO_TogglePin(GPIO_TypeDef *GPIOx, u16 Pin);
+GPIO_ErrorStatus_t GPIO_SetAlternateFunction(GPIO_TypeDef *GPIOx, u16 Pin, u8 AlternateFunction);
+GPIO_ErrorStatus_t GPIO_LockPin(GPIO_TypeDef *GPIOx, u16 Pin);
+
 #endif // _GPIO_H
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "pwr.h"
+#include "rcc.h"
+
+static PWR_Stats_t PWR_Stats;
+static u32 (*PWR_GetTick)(void) = NULL;
+static void (*PWR_WakeHook)(void) = NULL;
+
+// User time base if set, the DWT cycle counter otherwise
+static u32 PWR_GetTime(void)
+{
+    return (PWR_GetTick != NULL) ? PWR_GetTick() : DWT_CYCCNT;
+}
+
+/*Account one wake-up in the statistics.
+the DWT counter is frozen in STOP mode, so STOP time is only accounted
+when a time base was set with PWR_SetTimeBase. a single entry must stay
+below one wrap of the tick (25.5s of DWT cycles at 168MHz), the totals are 64 bit*/
+static void PWR_UpdateStats(PWR_Mode_t Mode, u32 TimeInMode, u32 WakeLatency, u32 HookTime)
+{
+    if (Mode == PWR_MODE_SLEEP)
+    {
+        PWR_Stats.sleepCount++;
+        PWR_Stats.totalTimeInSleep += TimeInMode;
+        PWR_Stats.lastTimeInMode = TimeInMode;
+    }
+    else
+    {
+        PWR_Stats.stopCount++;
+        if (PWR_GetTick != NULL)
+        {
+            PWR_Stats.totalTimeInStop += TimeInMode;
+            PWR_Stats.lastTimeInMode = TimeInMode;
+        }
+        else
+        {
+            PWR_Stats.lastTimeInMode = 0;
+        }
+    }
+
+    PWR_Stats.lastWakeLatency = WakeLatency;
+    PWR_Stats.lastHookTime = HookTime;
+
+    if (WakeLatency < PWR_Stats.minWakeLatency)
+    {
+        PWR_Stats.minWakeLatency = WakeLatency;
+    }
+    if (WakeLatency > PWR_Stats.maxWakeLatency)
+    {
+        PWR_Stats.maxWakeLatency = WakeLatency;
+    }
+}
+
+PWR_ErrorStatus_t PWR_Init(void)
+{
+    if (RCC_EnablePeripheralClock(PWR_EN_BIT) != RCC_OK)
+    {
+        return PWR_NOK;
+    }
+
+    // Enable the DWT cycle counter used to measure the wake-up latency
+    DEMCR |= (1U << DEMCR_TRCENA_BIT);
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= (1U << DWT_CYCCNTENA_BIT);
+
+    return PWR_ResetStats();
+}
+
+/*Set the tick source used for time-in-mode (RTC/LPTIM based).
+it is required for STOP time, without it only SLEEP time is measured (DWT cycles)*/
+PWR_ErrorStatus_t PWR_SetTimeBase(u32 (*GetTick)(void))
+{
+    if (GetTick == NULL)
+    {
+        return PWR_NULL_PTR;
+    }
+
+    PWR_GetTick = GetTick;
+    return PWR_OK;
+}
+
+/*Register wake-up work that runs while the PLL is locking after STOP mode.
+it runs on HSI with interrupts masked, pass NULL to remove the hook*/
+PWR_ErrorStatus_t PWR_SetWakeHook(void (*WakeHook)(void))
+{
+    PWR_WakeHook = WakeHook;
+    return PWR_OK;
+}
+
+PWR_ErrorStatus_t PWR_EnterLowPower(PWR_Mode_t Mode, PWR_Regulator_t Regulator)
+{
+    RCC_ClkConfig_t ClkConfig;
+    PWR_ErrorStatus_t Loc_Status = PWR_OK;
+    u32 primask;
+    u32 enterTick;
+    u32 wakeTick;
+    u32 wakeCycles;
+    u32 hookCycles = 0;
+
+    switch (Mode)
+    {
+    case PWR_MODE_SLEEP:
+        SCB_SCR &= ~(1U << SCB_SCR_SLEEPDEEP_BIT);
+        break;
+    case PWR_MODE_STOP:
+        // Snapshot the clock tree, STOP mode falls back to HSI on wake-up
+        RCC_SaveClkConfig(&ClkConfig);
+
+        PWR->CR &= ~(1U << PWR_CR_PDDS_BIT);
+        if (Regulator == PWR_REGULATOR_LOW_POWER)
+        {
+            PWR->CR |= (1U << PWR_CR_LPDS_BIT);
+        }
+        else
+        {
+            PWR->CR &= ~(1U << PWR_CR_LPDS_BIT);
+        }
+        PWR->CR |= (1U << PWR_CR_CWUF_BIT);
+        SCB_SCR |= (1U << SCB_SCR_SLEEPDEEP_BIT);
+        break;
+    default:
+        return PWR_INVALID_MODE;
+    }
+
+    /* Keep the wake-up ISR pending until the clocks are back, otherwise it
+       runs on HSI with wrong APB clocks. a pending IRQ still wakes WFI */
+    primask = CORE_DisableIrq();
+    enterTick = PWR_GetTime();
+
+    __asm volatile("dsb");
+    __asm volatile("wfi");
+
+    wakeCycles = DWT_CYCCNT;
+    wakeTick = PWR_GetTime();
+
+    if (Mode == PWR_MODE_STOP)
+    {
+        SCB_SCR &= ~(1U << SCB_SCR_SLEEPDEEP_BIT);
+
+        // Let the PLL lock while the application does its own wake-up work
+        if (RCC_RestoreClkStart(&ClkConfig) != RCC_OK)
+        {
+            Loc_Status = PWR_CLK_RESTORE_FAILED;
+        }
+        if (PWR_WakeHook != NULL)
+        {
+            hookCycles = DWT_CYCCNT;
+            PWR_WakeHook();
+            hookCycles = DWT_CYCCNT - hookCycles;
+        }
+        if (RCC_RestoreClkFinish(&ClkConfig) != RCC_OK)
+        {
+            Loc_Status = PWR_CLK_RESTORE_FAILED;
+        }
+    }
+
+    // Clock restore time only, the hook is reported on its own
+    wakeCycles = DWT_CYCCNT - wakeCycles - hookCycles;
+    PWR_UpdateStats(Mode, wakeTick - enterTick, wakeCycles, hookCycles);
+    CORE_RestoreIrq(primask);
+
+    return Loc_Status;
+}
+
+PWR_ErrorStatus_t PWR_GetStats(PWR_Stats_t *Stats)
+{
+    if (Stats == NULL)
+    {
+        return PWR_NULL_PTR;
+    }
+
+    *Stats = PWR_Stats;
+    return PWR_OK;
+}
+
+PWR_ErrorStatus_t PWR_ResetStats(void)
+{
+    PWR_Stats.sleepCount = 0;
+    PWR_Stats.stopCount = 0;
+    PWR_Stats.lastWakeLatency = 0;
+    PWR_Stats.minWakeLatency = 0xFFFFFFFFU;
+    PWR_Stats.maxWakeLatency = 0;
+    PWR_Stats.lastHookTime = 0;
+    PWR_Stats.lastTimeInMode = 0;
+    PWR_Stats.totalTimeInSleep = 0;
+    PWR_Stats.totalTimeInStop = 0;
+    return PWR_OK;
+}
@@ -0,0 +1,70 @@
+#ifndef _PWR_H_
+#define _PWR_H_
+
+#include "STD_TYPES.h"
+#include "CORTEX_M4.h"
+// PWR Registers base address
+#define PWR_BASE_ADDR        0x40007000U
+#define PWR                  ((PWR_TypeDef *)PWR_BASE_ADDR)
+
+/*************************************************************************/
+// PWR_CR bits
+#define PWR_CR_LPDS_BIT      0   // Low-power regulator in STOP mode
+#define PWR_CR_PDDS_BIT      1   // Power down deepsleep (STANDBY)
+#define PWR_CR_CWUF_BIT      2   // Clear wake-up flag
+#define PWR_CR_FPDS_BIT      9   // Flash power down in STOP mode
+
+// PWR_CSR bits
+#define PWR_CSR_WUF_BIT      0   // Wake-up flag
+
+/*************************************************************************/
+// PWR Registers Structure
+typedef struct {
+    volatile u32 CR;             // PWR power control register,            Offset: 0x00
+    volatile u32 CSR;            // PWR power control/status register,     Offset: 0x04
+} PWR_TypeDef;
+
+// PWR Error Status Enumeration
+typedef enum {
+    PWR_OK = 0,                      // Operation successful
+    PWR_NOK,                         // Operation failed
+    PWR_NULL_PTR,                    // NULL pointer passed
+    PWR_INVALID_MODE,                // Unknown low-power mode
+    PWR_CLK_RESTORE_FAILED           // Clock tree not restored after wake-up
+} PWR_ErrorStatus_t;
+
+// Low-Power Mode Enumeration
+typedef enum {
+    PWR_MODE_SLEEP = 0,              // Core clock stopped, peripherals running
+    PWR_MODE_STOP                    // All 1.2V domain clocks stopped, SYSCLK back to HSI on wake
+} PWR_Mode_t;
+
+// STOP Mode Regulator Enumeration
+typedef enum {
+    PWR_REGULATOR_MAIN = 0,          // Main regulator on (faster wake-up)
+    PWR_REGULATOR_LOW_POWER          // Low-power regulator (lower consumption)
+} PWR_Regulator_t;
+
+// Low-Power Statistics Structure
+typedef struct {
+    u32 sleepCount;                  // Number of SLEEP entries
+    u32 stopCount;                   // Number of STOP entries
+    u32 lastWakeLatency;             // Cycles from wake-up to clock tree restored, wake hook excluded
+    u32 minWakeLatency;              // Minimum wake-up latency (cycles)
+    u32 maxWakeLatency;              // Maximum wake-up latency (cycles)
+    u32 lastHookTime;                // Cycles spent in the wake hook on the last STOP wake-up
+    u32 lastTimeInMode;              // Ticks spent in the last low-power mode (one wrap of the tick max)
+    unsigned long long totalTimeInSleep; // Ticks spent in SLEEP mode (u64 is 32 bit on arm-none-eabi)
+    unsigned long long totalTimeInStop;  // Ticks spent in STOP mode (needs PWR_SetTimeBase)
+} PWR_Stats_t;
+
+/*************************************************************************/
+/* Function prototypes */
+PWR_ErrorStatus_t PWR_Init(void);
+PWR_ErrorStatus_t PWR_SetTimeBase(u32 (*GetTick)(void));
+PWR_ErrorStatus_t PWR_SetWakeHook(void (*WakeHook)(void));
+PWR_ErrorStatus_t PWR_EnterLowPower(PWR_Mode_t Mode, PWR_Regulator_t Regulator);
+PWR_ErrorStatus_t PWR_GetStats(PWR_Stats_t *Stats);
+PWR_ErrorStatus_t PWR_ResetStats(void);
+
+#endif // _PWR_H_
@@ -1,43 +1,6 @@
 #include "rcc.h"
-#include "stdint.h"
 
-typedef struct
-{
-    volatile uint32_t CR;         // RCC clock control register,                Offset: 0x00
-    volatile uint32_t PLLCFGR;    // RCC PLL configuration register,            Offset: 0x04
-    volatile uint32_t CFGR;       // RCC clock configuration register,          Offset: 0x08
-    volatile uint32_t CIR;        // RCC clock interrupt register,              Offset: 0x0C
-    volatile uint32_t AHB1RSTR;   // RCC AHB1 peripheral reset register,        Offset: 0x10
-    volatile uint32_t AHB2RSTR;   // RCC AHB2 peripheral reset register,        Offset: 0x14
-    volatile uint32_t AHB3RSTR;   // RCC AHB3 peripheral reset register,        Offset: 0x18
-    uint32_t RESERVED0;           // Reserved,                                  Offset: 0x1C
-    volatile uint32_t APB1RSTR;   // RCC APB1 peripheral reset register,        Offset: 0x20
-    volatile uint32_t APB2RSTR;   // RCC APB2 peripheral reset register,        Offset: 0x24
-    uint32_t RESERVED1[2];        // Reserved,                             Offset: 0x28-0x2C
-    volatile uint32_t AHB1ENR;    // RCC AHB1 peripheral clock enable register, Offset: 0x30
-    volatile uint32_t AHB2ENR;    // RCC AHB2 peripheral clock enable register, Offset: 0x34
-    volatile uint32_t AHB3ENR;    // RCC AHB3 peripheral clock enable register, Offset: 0x38
-    uint32_t RESERVED2;           // Reserved,                                  Offset: 0x3C
-    volatile uint32_t APB1ENR;    // RCC APB1 peripheral clock enable register, Offset: 0x40
-    volatile uint32_t APB2ENR;    // RCC APB2 peripheral clock enable register, Offset: 0x44
-    uint32_t RESERVED3[2];        // Reserved,                             Offset: 0x48-0x4C
-    volatile uint32_t AHB1LPENR;  // RCC AHB1 peripheral clock enable in low power mode register, Offset: 0x50
-    volatile uint32_t AHB2LPENR;  // RCC AHB2 peripheral clock enable in low power mode register, Offset: 0x54
-    volatile uint32_t AHB3LPENR;  // RCC AHB3 peripheral clock enable in low power mode register, Offset: 0x58
-    uint32_t RESERVED4;           // Reserved,                               Offset: 0x5C
-    volatile uint32_t APB1LPENR;  // RCC APB1 peripheral clock enable in low power mode register, Offset: 0x60
-    volatile uint32_t APB2LPENR;  // RCC APB2 peripheral clock enable in low power mode register, Offset: 0x64
-    uint32_t RESERVED5[2];        // Reserved,                                 Offset: 0x68-0x6C
-    volatile uint32_t BDCR;       // RCC Backup domain control register,            Offset: 0x70
-    volatile uint32_t CSR;        // RCC clock control & status register,           Offset: 0x74
-    uint32_t RESERVED6[2];        // Reserved,                                 Offset: 0x78-0x7C
-    volatile uint32_t SSCGR;      // RCC spread spectrum clock generation register, Offset: 0x80
-    volatile uint32_t PLLI2SCFGR; // RCC PLLI2S configuration register,             Offset: 0x84
-    volatile uint32_t PLLSAICFGR; // RCC PLLSAI configuration register,             Offset: 0x88
-    volatile uint32_t DCKCFGR;    // RCC dedicated clocks configuration register,   Offset: 0x8C
-} RCC_REGISTERS;
-
-RCC_err_status_t RCC_ClkEnable(uint32_t RCC_CLK)
+RCC_err_status_t RCC_ClkEnable(u32 RCC_CLK)
 {
     RCC_err_status_t Loc_Status = RCC_OK;
     switch (RCC_CLK)
@@ -56,13 +19,13 @@ RCC_err_status_t RCC_ClkEnable(uint32_t RCC_CLK)
         Loc_Status = RCC_NOK;
         break;
     }
-    return RCC_OK;
+    return Loc_Status;
 }
 
-RCC_err_status_t RCC_ClkSel(uint32_t RCC_CLK)
+RCC_err_status_t RCC_ClkSel(u32 RCC_CLK)
 {
     RCC_err_status_t Loc_Status = RCC_OK;
-    uint32_t isReady;
+    u32 isReady = 0;
     RCC_ClkIsReady(RCC_CLK, &isReady);
 
     if (!isReady)
@@ -89,10 +52,10 @@ RCC_err_status_t RCC_ClkSel(uint32_t RCC_CLK)
             break;
         }
     }
-    return RCC_OK;
+    return Loc_Status;
 }
 
-RCC_err_status_t RCC_ClkIsReady(uint32_t RCC_CLK, uint32_t *CLK_RDY)
+RCC_err_status_t RCC_ClkIsReady(u32 RCC_CLK, u32 *CLK_RDY)
 {
     switch (RCC_CLK)
     {
@@ -167,7 +130,7 @@ RCC_err_status_t RCC_PLL_Config(const PLL_CONFIG_t *pll_config_ptr)
     return RCC_OK;
 }
 
-RCC_err_status_t RCC_EnablePeripheralClock(uint32_t peripheral)
+RCC_err_status_t RCC_EnablePeripheralClock(u32 peripheral)
 {
     if (peripheral >= AHB1_START && peripheral <= AHB1_END)
     {
@@ -192,7 +155,7 @@ RCC_err_status_t RCC_EnablePeripheralClock(uint32_t peripheral)
     return RCC_OK;
 }
 
-RCC_err_status_t RCC_DisablePeripheralClock(uint32_t peripheral)
+RCC_err_status_t RCC_DisablePeripheralClock(u32 peripheral)
 {
     if (peripheral >= AHB1_START && peripheral <= AHB1_END)
     {
@@ -217,7 +180,7 @@ RCC_err_status_t RCC_DisablePeripheralClock(uint32_t peripheral)
     return RCC_OK;
 }
 
-RCC_err_status_t RCC_ResetPeripheral(uint32_t peripheral)
+RCC_err_status_t RCC_ResetPeripheral(u32 peripheral)
 {
     if (peripheral >= AHB1_START && peripheral <= AHB1_END)
     {
@@ -240,4 +203,119 @@ RCC_err_status_t RCC_ResetPeripheral(uint32_t peripheral)
         return RCC_INVALID_PERIPHERAL; // Invalid peripheral
     }
     return RCC_OK;
-}
\ No newline at end of file
+}
+
+/* Take a snapshot of the clock tree, call it before entering STOP mode */
+RCC_err_status_t RCC_SaveClkConfig(RCC_ClkConfig_t *ClkConfig)
+{
+    if (ClkConfig == NULL)
+    {
+        return RCC_NULL_PTR;
+    }
+
+    ClkConfig->CR = RCC->CR & (RCC_CLK_HSE | RCC_CLK_PLL | RCC_CLK_PLLI2S);
+    ClkConfig->PLLCFGR = RCC->PLLCFGR;
+    ClkConfig->CFGR = RCC->CFGR;
+
+    return RCC_OK;
+}
+
+/*Start restoring the clock tree after wake-up (the core is running on HSI).
+it only kicks off HSE and the PLLs (main and I2S) and does not wait for them to lock,
+so the caller can do other wake-up work before calling RCC_RestoreClkFinish*/
+RCC_err_status_t RCC_RestoreClkStart(const RCC_ClkConfig_t *ClkConfig)
+{
+    if (ClkConfig == NULL)
+    {
+        return RCC_NULL_PTR;
+    }
+
+    // Prescalers first, any value is safe while SYSCLK is HSI
+    RCC->CFGR = (RCC->CFGR & ~CFGR_PRESC_MASK) | (ClkConfig->CFGR & CFGR_PRESC_MASK);
+
+    if (ClkConfig->CR & RCC_CLK_HSE)
+    {
+        RCC->CR |= RCC_CLK_HSE;
+    }
+
+    if (ClkConfig->CR & RCC_CLK_PLL)
+    {
+        RCC->PLLCFGR = ClkConfig->PLLCFGR;
+    }
+
+    // HSI is already stable so the PLLs can start locking right away
+    if (((ClkConfig->PLLCFGR >> 22) & 0x1) == PLLSRC_HSI)
+    {
+        RCC->CR |= ClkConfig->CR & (RCC_CLK_PLL | RCC_CLK_PLLI2S);
+    }
+
+    return RCC_OK;
+}
+
+// Wait for the oscillators started by RCC_RestoreClkStart and switch SYSCLK back
+RCC_err_status_t RCC_RestoreClkFinish(const RCC_ClkConfig_t *ClkConfig)
+{
+    u32 timeout;
+    u32 sw;
+
+    if (ClkConfig == NULL)
+    {
+        return RCC_NULL_PTR;
+    }
+
+    if (ClkConfig->CR & RCC_CLK_HSE)
+    {
+        timeout = RCC_RDY_TIMEOUT;
+        while (!((RCC->CR >> HSE_RDY_BIT) & 0x1))
+        {
+            if (--timeout == 0)
+            {
+                return RCC_TIMEOUT;
+            }
+        }
+    }
+
+    if (ClkConfig->CR & RCC_CLK_PLL)
+    {
+        // PLLs fed from HSE could not be started before HSE was ready
+        RCC->CR |= ClkConfig->CR & (RCC_CLK_PLL | RCC_CLK_PLLI2S);
+
+        timeout = RCC_RDY_TIMEOUT;
+        while (!((RCC->CR >> PLL_RDY_BIT) & 0x1))
+        {
+            if (--timeout == 0)
+            {
+                return RCC_TIMEOUT;
+            }
+        }
+    }
+
+    sw = ClkConfig->CFGR & ~SW_CLR;
+    RCC->CFGR = (RCC->CFGR & SW_CLR) | sw;
+
+    timeout = RCC_RDY_TIMEOUT;
+    while (((RCC->CFGR & SWS_MASK) >> SWS_POS) != sw)
+    {
+        if (--timeout == 0)
+        {
+            return RCC_TIMEOUT;
+        }
+    }
+
+    // I2S clock last, SYSCLK does not depend on it
+    if (ClkConfig->CR & RCC_CLK_PLLI2S)
+    {
+        RCC->CR |= RCC_CLK_PLLI2S;
+
+        timeout = RCC_RDY_TIMEOUT;
+        while (!((RCC->CR >> PLLI2S_RDY_BIT) & 0x1))
+        {
+            if (--timeout == 0)
+            {
+                return RCC_TIMEOUT;
+            }
+        }
+    }
+
+    return RCC_OK;
+}
@@ -1,20 +1,26 @@
 #ifndef RCC_H_
 #define RCC_H_
 
-#define NULL    ((void *)0)   // Define NULL pointer
+#include "STD_TYPES.h"
+
 #define RCC_BASE_ADDR        0x40023800U    // RCC Base address 
-#define RCC                 ((RCC_REGISTERS *)RCC_BASE_ADDR) //RCC Registers structure pointer 
 /*************************************************************************/
 /* Clock source selection masks */
 #define SW_CLR               0xFFFFFFFC
 #define SW_HSI               0x0
 #define SW_HSE               0x1
 #define SW_PLL               0x2
+#define SWS_MASK             0x0000000C
+#define SWS_POS              2
+
+/* Bus prescaler masks (HPRE, PPRE1, PPRE2) */
+#define CFGR_PRESC_MASK      0x0000FCF0
 
 /* Clock enable bits */
 #define RCC_CLK_HSI          0x00000001
 #define RCC_CLK_HSE          0x00010000
 #define RCC_CLK_PLL          0x01000000
+#define RCC_CLK_PLLI2S       0x04000000
 
 // PLL configuration limits
 #define PLLM_MIN             2
@@ -32,6 +38,10 @@
 #define HSI_RDY_BIT          1
 #define HSE_RDY_BIT          17
 #define PLL_RDY_BIT          25
+#define PLLI2S_RDY_BIT       27
+
+/* Clock ready polling limit */
+#define RCC_RDY_TIMEOUT      0x0000FFFF
 /*************************************************************************/
 // Peripheral clock enable bits 
 // AHB1 peripherals
@@ -121,7 +131,8 @@ typedef enum {
     RCC_INVALID_PLLQ,
     RCC_INVALID_PLLSRC,
     RCC_INVALID_PERIPHERAL,
-    RCC_INVALID_BUS
+    RCC_INVALID_BUS,
+    RCC_TIMEOUT
 } RCC_err_status_t;
 /*************************************************************************/
 /* Clock source enumeration */
@@ -140,6 +151,59 @@ typedef struct {
     u32 PLLSRC; // PLL entry clock source (0 for HSI, 1 for HSE)
 } PLL_CONFIG_t;
 
+/*************************************************************************/
+/* RCC REGISTERS STRUCTURE */
+typedef struct
+{
+    volatile u32 CR;         // RCC clock control register,                Offset: 0x00
+    volatile u32 PLLCFGR;    // RCC PLL configuration register,            Offset: 0x04
+    volatile u32 CFGR;       // RCC clock configuration register,          Offset: 0x08
+    volatile u32 CIR;        // RCC clock interrupt register,              Offset: 0x0C
+    volatile u32 AHB1RSTR;   // RCC AHB1 peripheral reset register,        Offset: 0x10
+    volatile u32 AHB2RSTR;   // RCC AHB2 peripheral reset register,        Offset: 0x14
+    volatile u32 AHB3RSTR;   // RCC AHB3 peripheral reset register,        Offset: 0x18
+    u32 RESERVED0;           // Reserved,                                  Offset: 0x1C
+    volatile u32 APB1RSTR;   // RCC APB1 peripheral reset register,        Offset: 0x20
+    volatile u32 APB2RSTR;   // RCC APB2 peripheral reset register,        Offset: 0x24
+    u32 RESERVED1[2];        // Reserved,                             Offset: 0x28-0x2C
+    volatile u32 AHB1ENR;    // RCC AHB1 peripheral clock enable register, Offset: 0x30
+    volatile u32 AHB2ENR;    // RCC AHB2 peripheral clock enable register, Offset: 0x34
+    volatile u32 AHB3ENR;    // RCC AHB3 peripheral clock enable register, Offset: 0x38
+    u32 RESERVED2;           // Reserved,                                  Offset: 0x3C
+    volatile u32 APB1ENR;    // RCC APB1 peripheral clock enable register, Offset: 0x40
+    volatile u32 APB2ENR;    // RCC APB2 peripheral clock enable register, Offset: 0x44
+    u32 RESERVED3[2];        // Reserved,                             Offset: 0x48-0x4C
+    volatile u32 AHB1LPENR;  // RCC AHB1 peripheral clock enable in low power mode register, Offset: 0x50
+    volatile u32 AHB2LPENR;  // RCC AHB2 peripheral clock enable in low power mode register, Offset: 0x54
+    volatile u32 AHB3LPENR;  // RCC AHB3 peripheral clock enable in low power mode register, Offset: 0x58
+    u32 RESERVED4;           // Reserved,                               Offset: 0x5C
+    volatile u32 APB1LPENR;  // RCC APB1 peripheral clock enable in low power mode register, Offset: 0x60
+    volatile u32 APB2LPENR;  // RCC APB2 peripheral clock enable in low power mode register, Offset: 0x64
+    u32 RESERVED5[2];        // Reserved,                                 Offset: 0x68-0x6C
+    volatile u32 BDCR;       // RCC Backup domain control register,            Offset: 0x70
+    volatile u32 CSR;        // RCC clock control & status register,           Offset: 0x74
+    u32 RESERVED6[2];        // Reserved,                                 Offset: 0x78-0x7C
+    volatile u32 SSCGR;      // RCC spread spectrum clock generation register, Offset: 0x80
+    volatile u32 PLLI2SCFGR; // RCC PLLI2S configuration register,             Offset: 0x84
+    volatile u32 PLLSAICFGR; // RCC PLLSAI configuration register,             Offset: 0x88
+    volatile u32 DCKCFGR;    // RCC dedicated clocks configuration register,   Offset: 0x8C
+} RCC_REGISTERS;
+
+#ifdef RCC_HOST_SIM
+extern RCC_REGISTERS RCC_SimRegs;                   // RAM copy of the registers, defined by the host test
+#define RCC                 (&RCC_SimRegs)
+#else
+#define RCC                 ((RCC_REGISTERS *)RCC_BASE_ADDR) //RCC Registers structure pointer 
+#endif
+
+/*************************************************************************/
+/* CLOCK TREE SNAPSHOT (used to restore the clocks after STOP mode) */
+typedef struct {
+    u32 CR;      // HSEON / PLLON / PLLI2SON state at save time
+    u32 PLLCFGR; // PLL dividers and source
+    u32 CFGR;    // Bus prescalers and system clock switch
+} RCC_ClkConfig_t;
+
 /*************************************************************************/
 /* Function prototypes */
 RCC_err_status_t RCC_ClkEnable(u32 RCC_CLK);
@@ -147,5 +211,10 @@ RCC_err_status_t RCC_ClkSel(u32 RCC_CLK);
 RCC_err_status_t RCC_ClkIsReady(u32 RCC_CLK, u32 *CLK_RDY);
 RCC_err_status_t RCC_EnablePeripheralClock(u32 peripheral);
 RCC_err_status_t RCC_DisablePeripheralClock(u32 peripheral);
+RCC_err_status_t RCC_ResetPeripheral(u32 peripheral);
+RCC_err_status_t RCC_PLL_Config(const PLL_CONFIG_t *pll_config_ptr);
+RCC_err_status_t RCC_SaveClkConfig(RCC_ClkConfig_t *ClkConfig);
+RCC_err_status_t RCC_RestoreClkStart(const RCC_ClkConfig_t *ClkConfig);
+RCC_err_status_t RCC_RestoreClkFinish(const RCC_ClkConfig_t *ClkConfig);
 
 #endif /* RCC_H_ */
\ No newline at end of file
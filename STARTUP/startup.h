@@ -0,0 +1,15 @@
+#ifndef _STARTUP_H_
+#define _STARTUP_H_
+
+#include "STD_TYPES.h"
+
+// 16 core exception entries + 82 STM32F407 IRQs
+#define STARTUP_VECTOR_COUNT 98
+
+/* Build with -DSTARTUP_VECT_TAB_SRAM to copy the vector table to SRAM and
+   point VTOR at it, vector fetches then skip the flash wait states */
+
+// DWT cycles from the start of Reset_Handler to the call of main()
+extern volatile u32 Startup_ResetToMainCycles;
+
+#endif // _STARTUP_H_
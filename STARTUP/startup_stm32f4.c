@@ -0,0 +1,294 @@
+#include "startup.h"
+#include "CORTEX_M4.h"
+
+// Symbols defined in stm32f4_flash.ld
+extern u32 _estack;
+extern u32 _sidata, _sdata, _edata;
+extern u32 _sbss, _ebss;
+extern u32 _siccmdata, _sccmdata, _eccmdata;
+extern u32 _sccmbss, _eccmbss;
+
+extern int main(void);
+
+volatile u32 Startup_ResetToMainCycles;
+
+void Reset_Handler(void);
+void Default_Handler(void);
+
+// Core exceptions and IRQs, override by defining a function with the same name
+void NMI_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void HardFault_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void MemManage_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void BusFault_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void UsageFault_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void SVC_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void DebugMon_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void PendSV_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void SysTick_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void WWDG_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void PVD_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TAMP_STAMP_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void RTC_WKUP_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void FLASH_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void RCC_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void EXTI0_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void EXTI1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void EXTI2_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void EXTI3_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void EXTI4_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA1_Stream0_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA1_Stream1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA1_Stream2_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA1_Stream3_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA1_Stream4_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA1_Stream5_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA1_Stream6_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void ADC_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void CAN1_TX_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void CAN1_RX0_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void CAN1_RX1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void CAN1_SCE_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void EXTI9_5_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM1_BRK_TIM9_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM1_UP_TIM10_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM1_TRG_COM_TIM11_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM1_CC_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM2_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM3_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM4_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void I2C1_EV_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void I2C1_ER_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void I2C2_EV_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void I2C2_ER_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void SPI1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void SPI2_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void USART1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void USART2_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void USART3_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void EXTI15_10_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void RTC_Alarm_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void OTG_FS_WKUP_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM8_BRK_TIM12_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM8_UP_TIM13_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM8_TRG_COM_TIM14_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM8_CC_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA1_Stream7_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void FSMC_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void SDIO_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM5_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void SPI3_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void UART4_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void UART5_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM6_DAC_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM7_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA2_Stream0_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA2_Stream1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA2_Stream2_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA2_Stream3_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA2_Stream4_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void ETH_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void ETH_WKUP_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void CAN2_TX_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void CAN2_RX0_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void CAN2_RX1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void CAN2_SCE_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void OTG_FS_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA2_Stream5_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA2_Stream6_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA2_Stream7_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void USART6_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void I2C3_EV_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void I2C3_ER_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void OTG_HS_EP1_OUT_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void OTG_HS_EP1_IN_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void OTG_HS_WKUP_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void OTG_HS_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DCMI_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void CRYP_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void HASH_RNG_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void FPU_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+
+__attribute__((section(".isr_vector"), used))
+void (*const Startup_Vectors[STARTUP_VECTOR_COUNT])(void) = {
+    (void (*)(void))&_estack,
+    Reset_Handler,
+    NMI_Handler,
+    HardFault_Handler,
+    MemManage_Handler,
+    BusFault_Handler,
+    UsageFault_Handler,
+    0,
+    0,
+    0,
+    0,
+    SVC_Handler,
+    DebugMon_Handler,
+    0,
+    PendSV_Handler,
+    SysTick_Handler,
+    WWDG_IRQHandler,
+    PVD_IRQHandler,
+    TAMP_STAMP_IRQHandler,
+    RTC_WKUP_IRQHandler,
+    FLASH_IRQHandler,
+    RCC_IRQHandler,
+    EXTI0_IRQHandler,
+    EXTI1_IRQHandler,
+    EXTI2_IRQHandler,
+    EXTI3_IRQHandler,
+    EXTI4_IRQHandler,
+    DMA1_Stream0_IRQHandler,
+    DMA1_Stream1_IRQHandler,
+    DMA1_Stream2_IRQHandler,
+    DMA1_Stream3_IRQHandler,
+    DMA1_Stream4_IRQHandler,
+    DMA1_Stream5_IRQHandler,
+    DMA1_Stream6_IRQHandler,
+    ADC_IRQHandler,
+    CAN1_TX_IRQHandler,
+    CAN1_RX0_IRQHandler,
+    CAN1_RX1_IRQHandler,
+    CAN1_SCE_IRQHandler,
+    EXTI9_5_IRQHandler,
+    TIM1_BRK_TIM9_IRQHandler,
+    TIM1_UP_TIM10_IRQHandler,
+    TIM1_TRG_COM_TIM11_IRQHandler,
+    TIM1_CC_IRQHandler,
+    TIM2_IRQHandler,
+    TIM3_IRQHandler,
+    TIM4_IRQHandler,
+    I2C1_EV_IRQHandler,
+    I2C1_ER_IRQHandler,
+    I2C2_EV_IRQHandler,
+    I2C2_ER_IRQHandler,
+    SPI1_IRQHandler,
+    SPI2_IRQHandler,
+    USART1_IRQHandler,
+    USART2_IRQHandler,
+    USART3_IRQHandler,
+    EXTI15_10_IRQHandler,
+    RTC_Alarm_IRQHandler,
+    OTG_FS_WKUP_IRQHandler,
+    TIM8_BRK_TIM12_IRQHandler,
+    TIM8_UP_TIM13_IRQHandler,
+    TIM8_TRG_COM_TIM14_IRQHandler,
+    TIM8_CC_IRQHandler,
+    DMA1_Stream7_IRQHandler,
+    FSMC_IRQHandler,
+    SDIO_IRQHandler,
+    TIM5_IRQHandler,
+    SPI3_IRQHandler,
+    UART4_IRQHandler,
+    UART5_IRQHandler,
+    TIM6_DAC_IRQHandler,
+    TIM7_IRQHandler,
+    DMA2_Stream0_IRQHandler,
+    DMA2_Stream1_IRQHandler,
+    DMA2_Stream2_IRQHandler,
+    DMA2_Stream3_IRQHandler,
+    DMA2_Stream4_IRQHandler,
+    ETH_IRQHandler,
+    ETH_WKUP_IRQHandler,
+    CAN2_TX_IRQHandler,
+    CAN2_RX0_IRQHandler,
+    CAN2_RX1_IRQHandler,
+    CAN2_SCE_IRQHandler,
+    OTG_FS_IRQHandler,
+    DMA2_Stream5_IRQHandler,
+    DMA2_Stream6_IRQHandler,
+    DMA2_Stream7_IRQHandler,
+    USART6_IRQHandler,
+    I2C3_EV_IRQHandler,
+    I2C3_ER_IRQHandler,
+    OTG_HS_EP1_OUT_IRQHandler,
+    OTG_HS_EP1_IN_IRQHandler,
+    OTG_HS_WKUP_IRQHandler,
+    OTG_HS_IRQHandler,
+    DCMI_IRQHandler,
+    CRYP_IRQHandler,
+    HASH_RNG_IRQHandler,
+    FPU_IRQHandler,
+};
+
+#ifdef STARTUP_VECT_TAB_SRAM
+// VTOR needs the table aligned to its size rounded up to a power of two
+static void (*Startup_RamVectors[STARTUP_VECTOR_COUNT])(void) __attribute__((aligned(512)));
+#endif
+
+/*Copy words from flash to RAM, four per iteration.
+loop distribution is disabled so GCC does not turn it into a memcpy call*/
+__attribute__((optimize("no-tree-loop-distribute-patterns")))
+static void Startup_CopyWords(u32 *dst, const u32 *src, const u32 *end)
+{
+    while ((end - dst) >= 4)
+    {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        dst[3] = src[3];
+        dst += 4;
+        src += 4;
+    }
+    while (dst < end)
+    {
+        *dst++ = *src++;
+    }
+}
+
+// Zero words, four per iteration
+__attribute__((optimize("no-tree-loop-distribute-patterns")))
+static void Startup_ZeroWords(u32 *dst, const u32 *end)
+{
+    while ((end - dst) >= 4)
+    {
+        dst[0] = 0;
+        dst[1] = 0;
+        dst[2] = 0;
+        dst[3] = 0;
+        dst += 4;
+    }
+    while (dst < end)
+    {
+        *dst++ = 0;
+    }
+}
+
+void Reset_Handler(void)
+{
+    // Start counting cycles as early as possible
+    DEMCR |= (1U << DEMCR_TRCENA_BIT);
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= (1U << DWT_CYCCNTENA_BIT);
+
+#if defined(__ARM_FP)
+    // Enable the FPU before any compiler generated floating point code runs
+    SCB_CPACR |= CPACR_CP10_CP11_FULL;
+    __asm volatile("dsb");
+    __asm volatile("isb");
+#endif
+
+    // .data also holds the .ramfunc hot code
+    Startup_CopyWords(&_sdata, &_sidata, &_edata);
+    Startup_ZeroWords(&_sbss, &_ebss);
+    Startup_CopyWords(&_sccmdata, &_siccmdata, &_eccmdata);
+    Startup_ZeroWords(&_sccmbss, &_eccmbss);
+
+#ifdef STARTUP_VECT_TAB_SRAM
+    Startup_CopyWords((u32 *)Startup_RamVectors, (const u32 *)Startup_Vectors,
+                      (u32 *)Startup_RamVectors + STARTUP_VECTOR_COUNT);
+    SCB_VTOR = (u32)Startup_RamVectors;
+    __asm volatile("dsb");
+    __asm volatile("isb");
+#endif
+
+    Startup_ResetToMainCycles = DWT_CYCCNT;
+
+    main();
+
+    while (1); // main should never return
+}
+
+void Default_Handler(void)
+{
+    while (1); // Unhandled interrupt
+}
@@ -0,0 +1,35 @@
+/*
+ * test_check.h
+ *
+ * Minimal check macro and report shared by the host tests (one per executable)
+ */
+
+
+#ifndef TEST_CHECK_H_
+#define TEST_CHECK_H_
+
+#include <stdio.h>
+#include "STD_TYPES.h"
+
+static u32 Test_Failures = 0;
+
+#define CHECK(cond)                                                       \
+    do {                                                                  \
+        if (!(cond))                                                      \
+        {                                                                 \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);        \
+            Test_Failures++;                                              \
+        }                                                                 \
+    } while (0)
+
+/* Print the result line, return value is the test exit code */
+static inline int Test_Report(const char *Name)
+{
+    printf("%s: %s (%u failures)\n", Name, Test_Failures ? "FAILED" : "passed", Test_Failures);
+    return Test_Failures ? 1 : 0;
+}
+
+
+
+
+#endif /* TEST_CHECK_H_ */
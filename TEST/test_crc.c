@@ -0,0 +1,161 @@
+/*
+ * test_crc.c
+ *
+ * Host cross-check of the slicing-by-8 CRC against a bitwise reference.
+ * build with -DCRC_SOFTWARE_ONLY (make test)
+ */
+
+#include <stdlib.h>
+#include "crc.h"
+#include "test_check.h"
+
+#define TEST_BUF_SIZE        4096
+
+/* Bitwise model of the CRC unit: little endian words, MSB first,
+   trailing partial word zero padded */
+static u32 Ref_Crc(const u8 *Data, u32 Len)
+{
+    u32 crc = CRC_INIT_VALUE;
+    u32 i;
+    u32 b;
+    u32 word;
+
+    for (i = 0; i < Len; i += 4)
+    {
+        word = 0;
+        for (b = 0; b < 4; b++)
+        {
+            if (i + b < Len)
+            {
+                word |= (u32)Data[i + b] << (8 * b);
+            }
+        }
+
+        crc ^= word;
+        for (b = 0; b < 32; b++)
+        {
+            crc = (crc & 0x80000000U) ? ((crc << 1) ^ CRC_POLY) : (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+static u32 Soft_Crc(const u8 *Data, u32 Len, u32 Split1, u32 Split2)
+{
+    CRC_Context_t ctx;
+    u32 crc = 0;
+
+    CRC_SoftInit(&ctx);
+    CRC_SoftUpdate(&ctx, Data, Split1);
+    CRC_SoftUpdate(&ctx, Data + Split1, Split2 - Split1);
+    CRC_SoftUpdate(&ctx, Data + Split2, Len - Split2);
+    CRC_SoftFinal(&ctx, &crc);
+    return crc;
+}
+
+static void Test_KnownVector(void)
+{
+    const u8 word[4] = {0x78, 0x56, 0x34, 0x12}; // 0x12345678 as stored in memory
+    CRC_Context_t ctx;
+    u32 crc = 0;
+
+    CRC_SoftInit(&ctx);
+    CHECK(CRC_SoftUpdate(&ctx, word, 4) == CRC_OK);
+    CHECK(CRC_SoftFinal(&ctx, &crc) == CRC_OK);
+    CHECK(crc == 0xDF8A8A2BU);
+
+    CRC_SoftInit(&ctx);
+    CRC_SoftFinal(&ctx, &crc);
+    CHECK(crc == CRC_INIT_VALUE); // empty input
+}
+
+static void Test_NullPtr(void)
+{
+    CRC_Context_t ctx;
+    u32 crc;
+
+    CHECK(CRC_SoftInit(NULL) == CRC_NULL_PTR);
+    CRC_SoftInit(&ctx);
+    CHECK(CRC_SoftUpdate(NULL, (const u8 *)"a", 1) == CRC_NULL_PTR);
+    CHECK(CRC_SoftUpdate(&ctx, NULL, 1) == CRC_NULL_PTR);
+    CHECK(CRC_SoftUpdate(&ctx, NULL, 0) == CRC_OK);
+    CHECK(CRC_SoftFinal(&ctx, NULL) == CRC_NULL_PTR);
+    CHECK(CRC_Final(NULL, &crc) == CRC_NULL_PTR);
+}
+
+// Every length up to 64 with every split point and every alignment
+static void Test_AllSplits(const u8 *Buf)
+{
+    u32 len;
+    u32 split;
+    u32 offset;
+    u32 ref;
+
+    for (offset = 0; offset < 4; offset++)
+    {
+        for (len = 0; len <= 64; len++)
+        {
+            ref = Ref_Crc(Buf + offset, len);
+            for (split = 0; split <= len; split++)
+            {
+                CHECK(Soft_Crc(Buf + offset, len, split, split) == ref);
+                CHECK(Soft_Crc(Buf + offset, len, split / 2, split) == ref);
+            }
+        }
+    }
+}
+
+// Random lengths, split points and alignments up to the full buffer
+static void Test_RandomSplits(const u8 *Buf)
+{
+    u32 i;
+    u32 len;
+    u32 offset;
+    u32 s1;
+    u32 s2;
+
+    for (i = 0; i < 2000; i++)
+    {
+        offset = (u32)rand() % 4;
+        len = (u32)rand() % (TEST_BUF_SIZE - offset + 1);
+        s1 = len ? (u32)rand() % (len + 1) : 0;
+        s2 = s1 + ((len - s1) ? (u32)rand() % (len - s1 + 1) : 0);
+        CHECK(Soft_Crc(Buf + offset, len, s1, s2) == Ref_Crc(Buf + offset, len));
+    }
+}
+
+// The main API (software backend on the host) matches CRC_Soft*
+static void Test_MainApi(const u8 *Buf)
+{
+    CRC_Context_t ctx;
+    u32 crc = 0;
+
+    CHECK(CRC_Init(&ctx) == CRC_OK);
+    CHECK(CRC_Update(&ctx, Buf + 1, 1000) == CRC_OK);
+    CHECK(CRC_UpdateDMAStart(&ctx, Buf + 1001, 2003) == CRC_OK);
+    CHECK(CRC_UpdateDMAPoll(&ctx) == CRC_OK);
+    CHECK(CRC_UpdateDMA(&ctx, Buf + 3004, 1001) == CRC_OK);
+    CHECK(CRC_Final(&ctx, &crc) == CRC_OK);
+    CHECK(crc == Ref_Crc(Buf + 1, 4004));
+}
+
+int main(void)
+{
+    static u8 buf[TEST_BUF_SIZE];
+    u32 i;
+
+    srand(1);
+    for (i = 0; i < TEST_BUF_SIZE; i++)
+    {
+        buf[i] = (u8)rand();
+    }
+
+    Test_KnownVector();
+    Test_NullPtr();
+    Test_AllSplits(buf);
+    Test_RandomSplits(buf);
+    Test_MainApi(buf);
+
+    return Test_Report("test_crc");
+}
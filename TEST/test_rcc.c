@@ -0,0 +1,207 @@
+/*
+ * test_rcc.c
+ *
+ * Host test of the RCC clock tree save/restore on a RAM copy of the registers.
+ * build with -DRCC_HOST_SIM (make test)
+ */
+
+#include "rcc.h"
+#include "test_check.h"
+
+RCC_REGISTERS RCC_SimRegs;
+
+// CR bits used by the tests
+#define CR_HSION             RCC_CLK_HSI
+#define CR_HSIRDY            (1U << HSI_RDY_BIT)
+#define CR_HSEON             RCC_CLK_HSE
+#define CR_HSERDY            (1U << HSE_RDY_BIT)
+#define CR_PLLON             RCC_CLK_PLL
+#define CR_PLLRDY            (1U << PLL_RDY_BIT)
+#define CR_PLLI2SON          RCC_CLK_PLLI2S
+#define CR_PLLI2SRDY         (1U << PLLI2S_RDY_BIT)
+
+#define PLLCFGR_RESET        0x24003010U
+#define PLLCFGR_HSE_168MHZ   ((8U << 0) | (336U << 6) | (0U << 16) | (1U << 22) | (7U << 24))
+#define PLLCFGR_HSI_84MHZ    ((16U << 0) | (336U << 6) | (1U << 16) | (0U << 22) | (7U << 24))
+#define CFGR_PRESC_168MHZ    ((0x5U << 10) | (0x4U << 13)) // APB1 /4, APB2 /2
+
+static void Sim_Run(u32 CR, u32 PLLCFGR, u32 CFGR)
+{
+    RCC_SimRegs.CR = CR;
+    RCC_SimRegs.PLLCFGR = PLLCFGR;
+    RCC_SimRegs.CFGR = CFGR;
+}
+
+// STOP mode wake-up: HSI on, PLL/HSE off, SYSCLK back to HSI
+static void Sim_WakeFromStop(void)
+{
+    RCC_SimRegs.CR = CR_HSION | CR_HSIRDY;
+    RCC_SimRegs.CFGR &= ~(SWS_MASK | ~SW_CLR);
+}
+
+// Hardware side of RCC_RestoreClkFinish: oscillators ready, SWS follows SW
+static void Sim_ClocksReady(u32 Sws)
+{
+    RCC_SimRegs.CR |= CR_HSERDY | CR_PLLRDY;
+    RCC_SimRegs.CFGR = (RCC_SimRegs.CFGR & ~SWS_MASK) | (Sws << SWS_POS);
+}
+
+static void Test_SaveClkConfig(void)
+{
+    RCC_ClkConfig_t cfg;
+
+    Sim_Run(CR_HSION | CR_HSIRDY | CR_HSEON | CR_HSERDY | CR_PLLON | CR_PLLRDY,
+            PLLCFGR_HSE_168MHZ, CFGR_PRESC_168MHZ | SW_PLL | (SW_PLL << SWS_POS));
+
+    CHECK(RCC_SaveClkConfig(&cfg) == RCC_OK);
+    CHECK(cfg.CR == (CR_HSEON | CR_PLLON));
+    CHECK(cfg.PLLCFGR == PLLCFGR_HSE_168MHZ);
+    CHECK(cfg.CFGR == (CFGR_PRESC_168MHZ | SW_PLL | (SW_PLL << SWS_POS)));
+
+    CHECK(RCC_SaveClkConfig(NULL) == RCC_NULL_PTR);
+    CHECK(RCC_RestoreClkStart(NULL) == RCC_NULL_PTR);
+    CHECK(RCC_RestoreClkFinish(NULL) == RCC_NULL_PTR);
+}
+
+static void Test_RestoreHsePll(void)
+{
+    RCC_ClkConfig_t cfg;
+
+    Sim_Run(CR_HSION | CR_HSIRDY | CR_HSEON | CR_HSERDY | CR_PLLON | CR_PLLRDY,
+            PLLCFGR_HSE_168MHZ, CFGR_PRESC_168MHZ | SW_PLL | (SW_PLL << SWS_POS));
+    RCC_SaveClkConfig(&cfg);
+
+    Sim_WakeFromStop();
+    RCC_SimRegs.PLLCFGR = PLLCFGR_RESET;
+    RCC_SimRegs.CFGR = 0;
+
+    CHECK(RCC_RestoreClkStart(&cfg) == RCC_OK);
+    CHECK(RCC_SimRegs.CR & CR_HSEON);
+    CHECK(!(RCC_SimRegs.CR & CR_PLLON)); // waits for HSE
+    CHECK(RCC_SimRegs.PLLCFGR == PLLCFGR_HSE_168MHZ);
+    CHECK((RCC_SimRegs.CFGR & CFGR_PRESC_MASK) == CFGR_PRESC_168MHZ);
+    CHECK((RCC_SimRegs.CFGR & ~SW_CLR) == SW_HSI);
+
+    Sim_ClocksReady(SW_PLL);
+    CHECK(RCC_RestoreClkFinish(&cfg) == RCC_OK);
+    CHECK(RCC_SimRegs.CR & CR_PLLON);
+    CHECK((RCC_SimRegs.CFGR & ~SW_CLR) == SW_PLL);
+    CHECK((RCC_SimRegs.CFGR & CFGR_PRESC_MASK) == CFGR_PRESC_168MHZ);
+}
+
+static void Test_RestoreHsiPll(void)
+{
+    RCC_ClkConfig_t cfg;
+
+    Sim_Run(CR_HSION | CR_HSIRDY | CR_PLLON | CR_PLLRDY,
+            PLLCFGR_HSI_84MHZ, (0x4U << 10) | SW_PLL | (SW_PLL << SWS_POS));
+    RCC_SaveClkConfig(&cfg);
+
+    Sim_WakeFromStop();
+    RCC_SimRegs.PLLCFGR = PLLCFGR_RESET;
+
+    CHECK(RCC_RestoreClkStart(&cfg) == RCC_OK);
+    CHECK(!(RCC_SimRegs.CR & CR_HSEON));
+    CHECK(RCC_SimRegs.CR & CR_PLLON); // HSI is stable, PLL starts at once
+    CHECK(RCC_SimRegs.PLLCFGR == PLLCFGR_HSI_84MHZ);
+
+    RCC_SimRegs.CR |= CR_PLLRDY;
+    RCC_SimRegs.CFGR |= (SW_PLL << SWS_POS);
+    CHECK(RCC_RestoreClkFinish(&cfg) == RCC_OK);
+    CHECK(!(RCC_SimRegs.CR & CR_HSEON));
+    CHECK((RCC_SimRegs.CFGR & ~SW_CLR) == SW_PLL);
+    CHECK((RCC_SimRegs.CFGR & CFGR_PRESC_MASK) == (0x4U << 10));
+}
+
+static void Test_RestoreHse(void)
+{
+    RCC_ClkConfig_t cfg;
+
+    Sim_Run(CR_HSION | CR_HSIRDY | CR_HSEON | CR_HSERDY,
+            PLLCFGR_RESET, SW_HSE | (SW_HSE << SWS_POS));
+    RCC_SaveClkConfig(&cfg);
+
+    Sim_WakeFromStop();
+    RCC_SimRegs.PLLCFGR = PLLCFGR_HSI_84MHZ; // must be left alone
+
+    CHECK(RCC_RestoreClkStart(&cfg) == RCC_OK);
+    CHECK(RCC_SimRegs.CR & CR_HSEON);
+    CHECK(RCC_SimRegs.PLLCFGR == PLLCFGR_HSI_84MHZ);
+
+    RCC_SimRegs.CR |= CR_HSERDY;
+    RCC_SimRegs.CFGR |= (SW_HSE << SWS_POS);
+    CHECK(RCC_RestoreClkFinish(&cfg) == RCC_OK);
+    CHECK(!(RCC_SimRegs.CR & CR_PLLON));
+    CHECK((RCC_SimRegs.CFGR & ~SW_CLR) == SW_HSE);
+}
+
+static void Test_RestorePllI2s(void)
+{
+    RCC_ClkConfig_t cfg;
+
+    // HSE sourced PLL and PLLI2S, both switched off by STOP
+    Sim_Run(CR_HSION | CR_HSIRDY | CR_HSEON | CR_HSERDY | CR_PLLON | CR_PLLRDY | CR_PLLI2SON | CR_PLLI2SRDY,
+            PLLCFGR_HSE_168MHZ, CFGR_PRESC_168MHZ | SW_PLL | (SW_PLL << SWS_POS));
+    CHECK(RCC_SaveClkConfig(&cfg) == RCC_OK);
+    CHECK(cfg.CR == (CR_HSEON | CR_PLLON | CR_PLLI2SON));
+
+    Sim_WakeFromStop();
+    CHECK(RCC_RestoreClkStart(&cfg) == RCC_OK);
+    CHECK(!(RCC_SimRegs.CR & CR_PLLI2SON)); // waits for HSE
+
+    // PLLI2S never locks, SYSCLK is still restored
+    Sim_ClocksReady(SW_PLL);
+    CHECK(RCC_RestoreClkFinish(&cfg) == RCC_TIMEOUT);
+    CHECK(RCC_SimRegs.CR & CR_PLLI2SON);
+    CHECK((RCC_SimRegs.CFGR & ~SW_CLR) == SW_PLL);
+
+    RCC_SimRegs.CR |= CR_PLLI2SRDY;
+    CHECK(RCC_RestoreClkFinish(&cfg) == RCC_OK);
+
+    // HSI sourced, PLLI2S alone starts at once
+    Sim_Run(CR_HSION | CR_HSIRDY | CR_PLLI2SON | CR_PLLI2SRDY, PLLCFGR_HSI_84MHZ, SW_HSI);
+    RCC_SaveClkConfig(&cfg);
+    Sim_WakeFromStop();
+    CHECK(RCC_RestoreClkStart(&cfg) == RCC_OK);
+    CHECK(RCC_SimRegs.CR & CR_PLLI2SON);
+    CHECK(!(RCC_SimRegs.CR & CR_PLLON));
+}
+
+static void Test_RestoreTimeout(void)
+{
+    RCC_ClkConfig_t cfg;
+
+    // HSE never gets ready
+    Sim_Run(CR_HSION | CR_HSIRDY | CR_HSEON | CR_HSERDY | CR_PLLON | CR_PLLRDY,
+            PLLCFGR_HSE_168MHZ, SW_PLL | (SW_PLL << SWS_POS));
+    RCC_SaveClkConfig(&cfg);
+    Sim_WakeFromStop();
+    CHECK(RCC_RestoreClkStart(&cfg) == RCC_OK);
+    CHECK(RCC_RestoreClkFinish(&cfg) == RCC_TIMEOUT);
+    CHECK((RCC_SimRegs.CFGR & ~SW_CLR) == SW_HSI); // SYSCLK left on HSI
+
+    // PLL never locks
+    Sim_WakeFromStop();
+    RCC_RestoreClkStart(&cfg);
+    RCC_SimRegs.CR |= CR_HSERDY;
+    CHECK(RCC_RestoreClkFinish(&cfg) == RCC_TIMEOUT);
+    CHECK((RCC_SimRegs.CFGR & ~SW_CLR) == SW_HSI);
+
+    // Clock switch never reported in SWS
+    Sim_WakeFromStop();
+    RCC_RestoreClkStart(&cfg);
+    RCC_SimRegs.CR |= CR_HSERDY | CR_PLLRDY;
+    CHECK(RCC_RestoreClkFinish(&cfg) == RCC_TIMEOUT);
+}
+
+int main(void)
+{
+    Test_SaveClkConfig();
+    Test_RestoreHsePll();
+    Test_RestoreHsiPll();
+    Test_RestoreHse();
+    Test_RestorePllI2s();
+    Test_RestoreTimeout();
+
+    return Test_Report("test_rcc");
+}